@@ -0,0 +1,22 @@
+#include "scheduler.hpp"
+
+auto Scheduler::schedule(std::coroutine_handle<> coroutine) -> void {
+  if (!coroutine.done()) {
+    ready.push_back(coroutine);
+  }
+}
+
+auto Scheduler::run() -> void {
+  while (!ready.empty()) {
+    std::coroutine_handle<> coroutine = ready.front();
+    ready.pop_front();
+    coroutine.resume();
+    if (!coroutine.done()) {
+      ready.push_back(coroutine);
+    }
+  }
+}
+
+auto Scheduler::pending() const -> size_t {
+  return ready.size();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+
+// Executor local de un solo hilo: reanuda las corrutinas en round-robin para
+// que, mientras una espera el prefetch de su siguiente nodo, las demás avancen.
+class Scheduler {
+  std::deque<std::coroutine_handle<>> ready;
+
+ public:
+  // La corrutina no pasa a ser del `Scheduler`; quien la creó (el `Task`)
+  // debe seguir vivo hasta que `run` termine.
+  auto schedule(std::coroutine_handle<> coroutine) -> void;
+  // Reanuda corrutinas hasta que todas hayan terminado.
+  auto run() -> void;
+  [[nodiscard]] auto pending() const -> size_t;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+// Corrutina perezosa: no avanza hasta que alguien la reanuda (normalmente un
+// `Scheduler`). Cada `co_await std::suspend_always{}` dentro del cuerpo es un
+// punto donde el `Scheduler` puede ceder el turno a otra corrutina.
+template <typename T>
+class Task {
+ public:
+  struct promise_type {
+    std::optional<T> result;
+    std::exception_ptr exception;
+
+    auto get_return_object() -> Task {
+      return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    auto final_suspend() noexcept -> std::suspend_always { return {}; }
+    auto return_value(T value) -> void { result = std::move(value); }
+    auto unhandled_exception() -> void {
+      exception = std::current_exception();
+    }
+  };
+
+  Task(const Task&) = delete;                     // copy constructor
+  auto operator=(const Task&) -> Task& = delete;  // copy assignment operator
+  Task(Task&& other) noexcept
+      : handle{std::exchange(other.handle, nullptr)} {}
+  auto operator=(Task&& other) noexcept -> Task& {
+    if (this != &other) {
+      if (handle) {
+        handle.destroy();
+      }
+      handle = std::exchange(other.handle, nullptr);
+    }
+    return *this;
+  }
+  ~Task() noexcept {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  [[nodiscard]] auto coroutine() const -> std::coroutine_handle<> {
+    return handle;
+  }
+  [[nodiscard]] auto done() const -> bool { return handle.done(); }
+  // Avanza la corrutina hasta su siguiente punto de suspensión.
+  auto resume() -> void { handle.resume(); }
+  // Solo debe llamarse cuando `done()` es `true`.
+  auto result() -> T& {
+    if (handle.promise().exception) {
+      std::rethrow_exception(handle.promise().exception);
+    }
+    return handle.promise().result.value();
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> coroutine)
+      : handle{coroutine} {}
+
+  std::coroutine_handle<promise_type> handle;
+};
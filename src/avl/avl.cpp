@@ -3,8 +3,13 @@
 #include <iostream>
 #include <optional>
 #include <type_traits>
+#include <vector>
 
+#include "../async/task.hpp"
+#include "../trace/trace.hpp"
 #include "../utils/helpers.hpp"
+#include "../utils/threadpool.hpp"
+#include "avlhook.cpp"
 
 template <typename T>
 concept MoveAssignable = std::is_move_assignable<T>::value;
@@ -29,12 +34,25 @@ struct Node {
         hr{0} {}
 };
 
+// `Node` ya tiene los mismos campos que un `AVLHook`, así que el `AVL` usa
+// `AVLAlgorithms` directamente sobre sus nodos.
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+struct NodeLinks {
+  static auto of(Node<KeyType, ValueType>* node) -> Node<KeyType, ValueType>& {
+    return *node;
+  }
+};
+
 // TODO: crear una clase extra que sea Map o Hash que use el AVL por debajo
 // TODO: ver integrar dicha ED con Node.js
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 class AVL {
+  using Algorithms = AVLAlgorithms<Node<KeyType, ValueType>,
+                                   NodeLinks<KeyType, ValueType>>;
+
   Node<KeyType, ValueType>* root;
   std::function<int(const KeyType&, const KeyType&)> comparator;
+  TraceRecorder* recorder;
 
  public:
   // Recibe un lambda que toma dos elementos `a` y `b` como
@@ -63,10 +81,51 @@ class AVL {
   auto find(const KeyType& key) const -> std::optional<ValueType>;
   auto findKey(const KeyType& key) const -> std::optional<KeyType>;
   auto iterativeFindKey(const KeyType& key) const -> std::optional<KeyType>;
+  // Versiones en corrutina de `find`, `iterativeFindKey` y de un recorrido
+  // por rango [`lo`, `hi`]. En cada nivel hacen prefetch del siguiente nodo y
+  // se suspenden, para que un `Scheduler` intercale varias búsquedas y oculte
+  // la latencia de memoria. El AVL no debe modificarse mientras haya
+  // corrutinas sin terminar.
+  auto asyncFind(KeyType key) const -> Task<std::optional<ValueType>>;
+  auto asyncFindKey(KeyType key) const -> Task<std::optional<KeyType>>;
+  auto asyncRange(
+      KeyType lo,
+      KeyType hi,
+      std::function<void(const KeyType&, const ValueType&)> process) const
+      -> Task<size_t>;
+  // Llena un AVL vacío con `items`: los ordena con un merge sort paralelo y
+  // arma un árbol balanceado repartiendo los subárboles entre los hilos de
+  // `pool`. Lanza `"duplicate key"` si hay llaves repetidas.
+  auto buildParallel(std::vector<std::tuple<KeyType, ValueType>> items,
+                     ThreadPool& pool) -> void;
+  // Igual que `inorder`, pero procesa los subárboles en paralelo y sin orden;
+  // `process` debe poder llamarse desde varios hilos a la vez.
+  auto parallelForEach(
+      const std::function<void(const KeyType&, const ValueType&)>& process,
+      ThreadPool& pool) const -> void;
+  // Reduce el AVL en paralelo respetando el orden _inorder_: `combine` debe
+  // ser asociativa, pero no necesita ser conmutativa.
+  template <typename Result>
+  auto parallelReduce(
+      const Result& identity,
+      const std::function<Result(const KeyType&, const ValueType&)>& map,
+      const std::function<Result(const Result&, const Result&)>& combine,
+      ThreadPool& pool) const -> Result;
+  // Graba en `recorder` cada `insert`, `iterativeInsert`, `remove`, `find`,
+  // `findKey` e `iterativeFindKey`; con `nullptr` deja de grabar. El AVL no es
+  // dueño del `recorder`. Solo para `KeyType` enteros. Las búsquedas siguen
+  // pudiendo hacerse desde varios hilos porque `record` es thread-safe, pero
+  // cualquier operación grabada lanza `"could not write trace file"` si el
+  // trace no se pudo escribir.
+  auto setTraceRecorder(TraceRecorder* traceRecorder) -> void;
+  // Verifica que las alturas guardadas sean las reales, que ningún nodo tenga
+  // factor de balance mayor a 1 y que los `parent` sean consistentes. Es
+  // `O(n)`, pensado para tests.
+  [[nodiscard]] auto isValid() const -> bool;
   ~AVL() noexcept;
 
  private:
-  auto fixup(Node<KeyType, ValueType>* _root) -> void;
+  inline auto trace(TraceOp op, const KeyType& key) const -> void;
   auto minimumNode(Node<KeyType, ValueType>* _root) const
       -> Node<KeyType, ValueType>*;
   auto maximumNode(Node<KeyType, ValueType>* _root) const
@@ -81,25 +140,36 @@ class AVL {
       Node<KeyType, ValueType>* _root,
       const std::function<void(const KeyType&, const ValueType&)>& process)
       const -> void;
-  auto leftRotation(Node<KeyType, ValueType>* x, Node<KeyType, ValueType>* y)
-      -> void;
-  auto rightRotation(Node<KeyType, ValueType>* x, Node<KeyType, ValueType>* y)
-      -> void;
   auto insertRecursive(Node<KeyType, ValueType>* current,
                        const KeyType& key,
                        const ValueType& value) -> void;
   inline auto getHeight(Node<KeyType, ValueType>* node) const -> int;
+  auto buildBalanced(std::vector<std::tuple<KeyType, ValueType>>& items,
+                     size_t lo,
+                     size_t hi,
+                     Node<KeyType, ValueType>* parent)
+      -> Node<KeyType, ValueType>*;
+  auto buildUpperLevels(std::vector<std::tuple<KeyType, ValueType>>& items,
+                        size_t lo,
+                        size_t hi,
+                        Node<KeyType, ValueType>* parent,
+                        Node<KeyType, ValueType>** slot,
+                        int levels,
+                        ThreadPool& pool) -> void;
+  auto refreshHeights(Node<KeyType, ValueType>* _root, int levels) -> void;
+  auto splitByHeight(
+      Node<KeyType, ValueType>* _root,
+      int maxHeight,
+      std::vector<std::tuple<Node<KeyType, ValueType>*, bool>>& pieces) const
+      -> void;
+  [[nodiscard]] auto splitHeight(const ThreadPool& pool) const -> int;
   auto clear(Node<KeyType, ValueType>* _root) -> void;
 };
 
-const int AVL_GREATER = 1;
-const int AVL_LESS = -1;
-const int AVL_EQUAL = 0;
-
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 AVL<KeyType, ValueType>::AVL(
     const std::function<int(const KeyType&, const KeyType&)>& comparator)
-    : root{nullptr}, comparator{comparator} {}
+    : root{nullptr}, comparator{comparator}, recorder{nullptr} {}
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 inline auto AVL<KeyType, ValueType>::getHeight() const -> int {
@@ -118,6 +188,7 @@ auto AVL<KeyType, ValueType>::getRoot() const -> std::optional<KeyType> {
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 void AVL<KeyType, ValueType>::insert(const KeyType& key,
                                      const ValueType& value) {
+  trace(TraceOp::Insert, key);
   if (root == nullptr) {
     root = new Node<KeyType, ValueType>(key, value);
   } else {
@@ -128,6 +199,7 @@ void AVL<KeyType, ValueType>::insert(const KeyType& key,
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 void AVL<KeyType, ValueType>::iterativeInsert(const KeyType& key,
                                               const ValueType& value) {
+  trace(TraceOp::Insert, key);
   if (root == nullptr) {
     root = new Node<KeyType, ValueType>(key, value);
   } else {
@@ -151,7 +223,7 @@ void AVL<KeyType, ValueType>::iterativeInsert(const KeyType& key,
       parent->left = new Node<KeyType, ValueType>(key, value);
       parent->left->parent = parent;
     }
-    fixup(parent);
+    Algorithms::fixup(root, parent);
   }
 }
 
@@ -193,6 +265,7 @@ auto AVL<KeyType, ValueType>::inorderString() const -> std::string {
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 auto AVL<KeyType, ValueType>::remove(const KeyType& key) -> void {
+  trace(TraceOp::Remove, key);
   Node<KeyType, ValueType>* nodeToRemove = findNode(key, root);
   if (nodeToRemove == nullptr) {
     return;
@@ -210,44 +283,42 @@ auto AVL<KeyType, ValueType>::remove(const KeyType& key) -> void {
       } else {
         nodeToRemove->parent->left = nullptr;
       }
-      fixup(nodeToRemove->parent);
+      Algorithms::fixup(root, nodeToRemove->parent);
     }
     delete nodeToRemove;
   } else if (leftChild == nullptr || rightChild == nullptr) {
     // node has one child
     Node<KeyType, ValueType>* child = leftChild ? leftChild : rightChild;
-    if (comparator(nodeToRemove->key, nodeToRemove->parent->key) ==
-        AVL_GREATER) {
+    if (nodeToRemove->parent == nullptr) {
+      root = child;
+    } else if (comparator(nodeToRemove->key, nodeToRemove->parent->key) ==
+               AVL_GREATER) {
       nodeToRemove->parent->right = child;
     } else {
       nodeToRemove->parent->left = child;
     }
     child->parent = nodeToRemove->parent;
-    fixup(nodeToRemove->parent);
+    Algorithms::fixup(root, nodeToRemove->parent);
     delete nodeToRemove;
   } else {
     // node has two children
     Node<KeyType, ValueType>* replacement = nodeToRemove->hl < nodeToRemove->hr
                                                 ? maximumNode(leftChild)
                                                 : minimumNode(rightChild);
+    // the replacement has at most one child, which takes its place
+    Node<KeyType, ValueType>* orphan =
+        replacement->left ? replacement->left : replacement->right;
     if (comparator(replacement->key, replacement->parent->key) == AVL_GREATER) {
-      if (replacement->left) {
-        replacement->parent->right = replacement->left;
-        replacement->left->parent = replacement->parent;
-      } else {
-        replacement->parent->right = nullptr;
-      }
+      replacement->parent->right = orphan;
     } else {
-      if (replacement->right) {
-        replacement->parent->left = replacement->right;
-        replacement->right->parent = replacement->parent;
-      } else {
-        replacement->parent->left = nullptr;
-      }
+      replacement->parent->left = orphan;
+    }
+    if (orphan) {
+      orphan->parent = replacement->parent;
     }
     nodeToRemove->key = std::move(replacement->key);
     nodeToRemove->value = std::move(replacement->value);
-    fixup(replacement->parent);
+    Algorithms::fixup(root, replacement->parent);
     delete replacement;
   }
 }
@@ -293,6 +364,7 @@ auto AVL<KeyType, ValueType>::successor(const KeyType& key) const
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 auto AVL<KeyType, ValueType>::findKey(const KeyType& key) const
     -> std::optional<KeyType> {
+  trace(TraceOp::Find, key);
   // NOLINTNEXTLINE
   Node<KeyType, ValueType>* foundNode = findNode(key, root);
   if (foundNode) {
@@ -304,6 +376,7 @@ auto AVL<KeyType, ValueType>::findKey(const KeyType& key) const
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 auto AVL<KeyType, ValueType>::find(const KeyType& key) const
     -> std::optional<ValueType> {
+  trace(TraceOp::Find, key);
   Node<KeyType, ValueType>* foundNode = findNode(key, root);
   if (foundNode) {
     return foundNode->value;
@@ -314,6 +387,7 @@ auto AVL<KeyType, ValueType>::find(const KeyType& key) const
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 auto AVL<KeyType, ValueType>::iterativeFindKey(const KeyType& key) const
     -> std::optional<KeyType> {
+  trace(TraceOp::Find, key);
   Node<KeyType, ValueType>* current = root;
   while (current) {
     int comp = comparator(key, current->key);
@@ -330,40 +404,232 @@ auto AVL<KeyType, ValueType>::iterativeFindKey(const KeyType& key) const
 }
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
-auto AVL<KeyType, ValueType>::fixup(Node<KeyType, ValueType>* _root) -> void {
-  while (_root != nullptr) {
-    Node<KeyType, ValueType>* nextParent = _root->parent;
-    _root->hl = getHeight(_root->left);
-    _root->hr = getHeight(_root->right);
-    int balanceFactor = _root->hl - _root->hr;
+auto AVL<KeyType, ValueType>::asyncFind(KeyType key) const
+    -> Task<std::optional<ValueType>> {
+  Node<KeyType, ValueType>* current = root;
+  while (current) {
+    int comp = comparator(key, current->key);
+    if (comp == AVL_EQUAL) {
+      co_return current->value;
+    }
+    current = comp == AVL_GREATER ? current->right : current->left;
+    if (current) {
+      __builtin_prefetch(current);
+      co_await std::suspend_always{};
+    }
+  }
+  co_return std::nullopt;
+}
 
-    if (balanceFactor < -1) {
-      // right heavy
-      // NOLINTNEXTLINE
-      int balanceFactorRight = _root->right->hl - _root->right->hr;
-      if (balanceFactorRight >= 0) {
-        // RL rotation
-        rightRotation(_root->right, _root->right->left);
-        leftRotation(_root, _root->right);
-      } else {
-        // L rotation
-        leftRotation(_root, _root->right);
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::asyncFindKey(KeyType key) const
+    -> Task<std::optional<KeyType>> {
+  Node<KeyType, ValueType>* current = root;
+  while (current) {
+    int comp = comparator(key, current->key);
+    if (comp == AVL_EQUAL) {
+      co_return current->key;
+    }
+    current = comp == AVL_GREATER ? current->right : current->left;
+    if (current) {
+      __builtin_prefetch(current);
+      co_await std::suspend_always{};
+    }
+  }
+  co_return std::nullopt;
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::asyncRange(
+    KeyType lo,
+    KeyType hi,
+    std::function<void(const KeyType&, const ValueType&)> process) const
+    -> Task<size_t> {
+  // primer nodo con key >= lo
+  Node<KeyType, ValueType>* first = nullptr;
+  Node<KeyType, ValueType>* current = root;
+  while (current) {
+    if (comparator(current->key, lo) == AVL_LESS) {
+      current = current->right;
+    } else {
+      first = current;
+      current = current->left;
+    }
+    if (current) {
+      __builtin_prefetch(current);
+      co_await std::suspend_always{};
+    }
+  }
+  size_t count = 0;
+  current = first;
+  while (current && comparator(current->key, hi) != AVL_GREATER) {
+    process(current->key, current->value);
+    ++count;
+    if (current->right) {
+      current = current->right;
+      __builtin_prefetch(current);
+      co_await std::suspend_always{};
+      while (current->left) {
+        current = current->left;
+        __builtin_prefetch(current);
+        co_await std::suspend_always{};
       }
-    } else if (balanceFactor > 1) {
-      // left heavy
-      // NOLINTNEXTLINE
-      int balanceFactorLeft = _root->left->hl - _root->left->hr;
-      if (balanceFactorLeft <= 0) {
-        // LR rotation
-        leftRotation(_root->left, _root->left->right);
-        rightRotation(_root, _root->left);
-      } else {
-        // R rotation
-        rightRotation(_root, _root->left);
+    } else {
+      // los ancestros ya se visitaron al bajar, están en caché
+      current = successorUp(current);
+    }
+  }
+  co_return count;
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::buildParallel(
+    std::vector<std::tuple<KeyType, ValueType>> items,
+    ThreadPool& pool) -> void {
+  if (root != nullptr) {
+    throw "tree is not empty";
+  }
+  auto less = [this](const std::tuple<KeyType, ValueType>& a,
+                     const std::tuple<KeyType, ValueType>& b) {
+    return comparator(std::get<0>(a), std::get<0>(b)) == AVL_LESS;
+  };
+  // merge sort: cada hilo ordena un bloque y luego se mezclan de a pares
+  size_t chunkCount = 1;
+  int levels = 0;
+  while (chunkCount < pool.threadCount() * 4) {
+    chunkCount *= 2;
+    ++levels;
+  }
+  size_t chunkSize = (items.size() + chunkCount - 1) / chunkCount;
+  if (chunkSize == 0) {
+    chunkSize = 1;
+  }
+  for (size_t lo = 0; lo < items.size(); lo += chunkSize) {
+    size_t hi = std::min(lo + chunkSize, items.size());
+    pool.submit([&items, &less, lo, hi]() {
+      std::sort(items.begin() + static_cast<std::ptrdiff_t>(lo),
+                items.begin() + static_cast<std::ptrdiff_t>(hi), less);
+    });
+  }
+  pool.wait();
+  for (size_t width = chunkSize; width < items.size(); width *= 2) {
+    for (size_t lo = 0; lo + width < items.size(); lo += 2 * width) {
+      size_t mid = lo + width;
+      size_t hi = std::min(lo + 2 * width, items.size());
+      pool.submit([&items, &less, lo, mid, hi]() {
+        std::inplace_merge(items.begin() + static_cast<std::ptrdiff_t>(lo),
+                           items.begin() + static_cast<std::ptrdiff_t>(mid),
+                           items.begin() + static_cast<std::ptrdiff_t>(hi),
+                           less);
+      });
+    }
+    pool.wait();
+  }
+  for (size_t i = 1; i < items.size(); ++i) {
+    if (comparator(std::get<0>(items[i - 1]), std::get<0>(items[i])) ==
+        AVL_EQUAL) {
+      throw "duplicate key";
+    }
+  }
+  // los primeros niveles se arman en este hilo, el resto en el pool
+  buildUpperLevels(items, 0, items.size(), nullptr, &root, levels, pool);
+  pool.wait();
+  refreshHeights(root, levels);
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::parallelForEach(
+    const std::function<void(const KeyType&, const ValueType&)>& process,
+    ThreadPool& pool) const -> void {
+  std::vector<std::tuple<Node<KeyType, ValueType>*, bool>> pieces;
+  splitByHeight(root, splitHeight(pool), pieces);
+  for (auto [piece, wholeSubtree] : pieces) {
+    if (wholeSubtree) {
+      pool.submit([this, piece, &process]() {
+        inorderTraversal(piece, process);
+      });
+    }
+  }
+  try {
+    for (auto [piece, wholeSubtree] : pieces) {
+      if (!wholeSubtree) {
+        process(piece->key, piece->value);
       }
     }
-    _root = nextParent;
+  } catch (...) {
+    // las tareas usan `process` y `pieces`: hay que esperarlas antes de salir
+    pool.drain();
+    throw;
   }
+  pool.wait();
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+template <typename Result>
+auto AVL<KeyType, ValueType>::parallelReduce(
+    const Result& identity,
+    const std::function<Result(const KeyType&, const ValueType&)>& map,
+    const std::function<Result(const Result&, const Result&)>& combine,
+    ThreadPool& pool) const -> Result {
+  std::vector<std::tuple<Node<KeyType, ValueType>*, bool>> pieces;
+  splitByHeight(root, splitHeight(pool), pieces);
+  // `std::optional` evita `std::vector<bool>`, cuyos elementos comparten bytes
+  // y no se pueden escribir desde varios hilos
+  std::vector<std::optional<Result>> partials(pieces.size(), identity);
+  for (size_t i = 0; i < pieces.size(); ++i) {
+    auto [piece, wholeSubtree] = pieces[i];
+    if (wholeSubtree) {
+      pool.submit([this, piece, &partial = partials[i], &map, &combine]() {
+        inorderTraversal(piece, [&partial, &map, &combine](
+                                    const KeyType& key,
+                                    const ValueType& value) {
+          partial = combine(*partial, map(key, value));
+        });
+      });
+    }
+  }
+  try {
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      auto [piece, wholeSubtree] = pieces[i];
+      if (!wholeSubtree) {
+        partials[i] = map(piece->key, piece->value);
+      }
+    }
+  } catch (...) {
+    // las tareas escriben en `partials`: hay que esperarlas antes de salir
+    pool.drain();
+    throw;
+  }
+  pool.wait();
+  // los parciales se combinan en orden inorder
+  Result result = identity;
+  for (const std::optional<Result>& partial : partials) {
+    result = combine(result, *partial);
+  }
+  return result;
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::setTraceRecorder(TraceRecorder* traceRecorder)
+    -> void {
+  static_assert(std::is_integral_v<KeyType>,
+                "traces can only record integral keys");
+  recorder = traceRecorder;
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+inline auto AVL<KeyType, ValueType>::trace(TraceOp op,
+                                           const KeyType& key) const -> void {
+  if constexpr (std::is_integral_v<KeyType>) {
+    if (recorder) {
+      recorder->record(op, static_cast<int64_t>(key));
+    }
+  }
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::isValid() const -> bool {
+  return Algorithms::isValid(root);
 }
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
@@ -438,52 +704,6 @@ void AVL<KeyType, ValueType>::inorderTraversal(
   inorderTraversal(_root->right, process);
 }
 
-template <MoveAssignable KeyType, MoveAssignable ValueType>
-void AVL<KeyType, ValueType>::leftRotation(Node<KeyType, ValueType>* x,
-                                           Node<KeyType, ValueType>* y) {
-  // NOLINTNEXTLINE
-  if (y->left) {
-    y->left->parent = x;
-  }
-  x->right = y->left;
-  if (x->parent == nullptr) {
-    root = y;
-  } else if (comparator(x->key, x->parent->key) == AVL_LESS) {
-    x->parent->left = y;
-  } else {
-    x->parent->right = y;
-  }
-  y->left = x;
-  y->parent = x->parent;
-  x->parent = y;
-
-  x->hr = getHeight(x->right);
-  y->hl = getHeight(y->left);
-}
-
-template <MoveAssignable KeyType, MoveAssignable ValueType>
-void AVL<KeyType, ValueType>::rightRotation(Node<KeyType, ValueType>* x,
-                                            Node<KeyType, ValueType>* y) {
-  // NOLINTNEXTLINE
-  if (y->right) {
-    y->right->parent = x;
-  }
-  x->left = y->right;
-  if (x->parent == nullptr) {
-    root = y;
-  } else if (comparator(x->key, x->parent->key) == AVL_GREATER) {
-    x->parent->right = y;
-  } else {
-    x->parent->left = y;
-  }
-  y->right = x;
-  y->parent = x->parent;
-  x->parent = y;
-
-  x->hl = getHeight(x->left);
-  y->hr = getHeight(y->right);
-}
-
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 void AVL<KeyType, ValueType>::insertRecursive(Node<KeyType, ValueType>* current,
                                               const KeyType& key,
@@ -493,57 +713,117 @@ void AVL<KeyType, ValueType>::insertRecursive(Node<KeyType, ValueType>* current,
     if (current->right == nullptr) {
       current->right = new Node<KeyType, ValueType>(key, value);
       current->right->parent = current;
-      current->hr = getHeight(current->right);
     } else {
       insertRecursive(current->right, key, value);
-      current->hr = getHeight(current->right);
-      int balanceFactor = current->hl - current->hr;
-      if (balanceFactor < -1) {
-        int balanceFactorRight = current->right->hl - current->right->hr;
-        if (balanceFactorRight >= 0) {
-          // RL rotation
-          rightRotation(current->right, current->right->left);
-          leftRotation(current, current->right);
-        } else {
-          // L rotation
-          leftRotation(current, current->right);
-        }
-      }
     }
   } else if (comp == AVL_LESS) {
     if (current->left == nullptr) {
       current->left = new Node<KeyType, ValueType>(key, value);
       current->left->parent = current;
-      current->hl = getHeight(current->left);
     } else {
       insertRecursive(current->left, key, value);
-      current->hl = getHeight(current->left);
-      int balanceFactor = current->hl - current->hr;
-      if (balanceFactor > 1) {
-        // left heavy
-        int balanceFactorLeft = current->left->hl - current->left->hr;
-        if (balanceFactorLeft <= 0) {
-          // LR rotation
-          leftRotation(current->left, current->left->right);
-          rightRotation(current, current->left);
-        } else {
-          // R rotation
-          rightRotation(current, current->left);
-        }
-      }
     }
   } else {
     throw "duplicated key";
   }
+  Algorithms::rebalance(root, current);
 }
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
 inline auto AVL<KeyType, ValueType>::getHeight(
     Node<KeyType, ValueType>* node) const -> int {
-  if (node == nullptr) {
-    return 0;
+  return Algorithms::getHeight(node);
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::buildBalanced(
+    std::vector<std::tuple<KeyType, ValueType>>& items,
+    size_t lo,
+    size_t hi,
+    Node<KeyType, ValueType>* parent) -> Node<KeyType, ValueType>* {
+  if (lo >= hi) {
+    return nullptr;
+  }
+  size_t mid = lo + (hi - lo) / 2;
+  auto* node = new Node<KeyType, ValueType>(std::get<0>(items[mid]),
+                                            std::get<1>(items[mid]));
+  node->parent = parent;
+  node->left = buildBalanced(items, lo, mid, node);
+  node->right = buildBalanced(items, mid + 1, hi, node);
+  node->hl = getHeight(node->left);
+  node->hr = getHeight(node->right);
+  return node;
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::buildUpperLevels(
+    std::vector<std::tuple<KeyType, ValueType>>& items,
+    size_t lo,
+    size_t hi,
+    Node<KeyType, ValueType>* parent,
+    Node<KeyType, ValueType>** slot,
+    int levels,
+    ThreadPool& pool) -> void {
+  if (lo >= hi) {
+    *slot = nullptr;
+    return;
+  }
+  if (levels == 0) {
+    pool.submit([this, &items, lo, hi, parent, slot]() {
+      *slot = buildBalanced(items, lo, hi, parent);
+    });
+    return;
+  }
+  size_t mid = lo + (hi - lo) / 2;
+  auto* node = new Node<KeyType, ValueType>(std::get<0>(items[mid]),
+                                            std::get<1>(items[mid]));
+  node->parent = parent;
+  *slot = node;
+  buildUpperLevels(items, lo, mid, node, &node->left, levels - 1, pool);
+  buildUpperLevels(items, mid + 1, hi, node, &node->right, levels - 1, pool);
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::refreshHeights(Node<KeyType, ValueType>* _root,
+                                             int levels) -> void {
+  if (_root == nullptr || levels == 0) {
+    return;
+  }
+  refreshHeights(_root->left, levels - 1);
+  refreshHeights(_root->right, levels - 1);
+  _root->hl = getHeight(_root->left);
+  _root->hr = getHeight(_root->right);
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::splitByHeight(
+    Node<KeyType, ValueType>* _root,
+    int maxHeight,
+    std::vector<std::tuple<Node<KeyType, ValueType>*, bool>>& pieces) const
+    -> void {
+  // cada pieza es un subárbol entero de altura <= `maxHeight` (`true`) o un
+  // nodo suelto de los que quedan por encima (`false`), en orden inorder
+  if (_root == nullptr) {
+    return;
+  }
+  if (getHeight(_root) <= maxHeight) {
+    pieces.emplace_back(_root, true);
+    return;
+  }
+  splitByHeight(_root->left, maxHeight, pieces);
+  pieces.emplace_back(_root, false);
+  splitByHeight(_root->right, maxHeight, pieces);
+}
+
+template <MoveAssignable KeyType, MoveAssignable ValueType>
+auto AVL<KeyType, ValueType>::splitHeight(const ThreadPool& pool) const
+    -> int {
+  // unas 4 piezas por hilo: bajar un nivel duplica la cantidad de subárboles
+  int levels = 2;
+  for (size_t threads = pool.threadCount(); threads > 1; threads /= 2) {
+    ++levels;
   }
-  return std::max({node->hl, node->hr}) + 1;
+  return std::max(getHeight() - levels, 1);
 }
 
 template <MoveAssignable KeyType, MoveAssignable ValueType>
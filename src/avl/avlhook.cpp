@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+
+const int AVL_GREATER = 1;
+const int AVL_LESS = -1;
+const int AVL_EQUAL = 0;
+
+// Enlaces de un AVL embebidos dentro de un objeto `T`. Un mismo objeto puede
+// tener varios hooks para estar en varios árboles a la vez.
+template <typename T>
+struct AVLHook {
+  T* left = nullptr;
+  T* right = nullptr;
+  T* parent = nullptr;
+  int hl = 0;
+  int hr = 0;
+};
+
+// Accede al hook `Member` de un objeto `T`.
+template <typename T, AVLHook<T> T::*Member>
+struct MemberHook {
+  static auto of(T* node) -> auto& { return node->*Member; }
+};
+
+// Algoritmos del AVL (inserción, borrado, `fixup` y rotaciones) sobre nodos
+// que no son dueños de nada: solo reenlazan los enlaces que `Hook::of`
+// devuelve, nunca reservan ni liberan memoria. `Hook::of(node)` puede
+// devolver un `AVLHook` o cualquier cosa con los mismos campos, como el
+// propio `Node` del `AVL`. Es la única implementación de las reglas de
+// rebalanceo: `AVL`, `IntrusiveAVL` y `AVLCache` la usan.
+template <typename T, typename Hook>
+class AVLAlgorithms {
+ public:
+  // `compare(a, b)` retorna -1 si `a < b`, 1 si `a > b` y 0 si `a == b`.
+  template <typename Compare>
+  static auto insert(T*& root, T* node, const Compare& compare) -> void;
+  // `probe(node)` compara la llave buscada contra la de `node` con la misma
+  // convención que `compare`.
+  template <typename Probe>
+  static auto find(T* root, const Probe& probe) -> T*;
+  // Desenlaza `node` en `O(lg n)` sin tener que buscarlo.
+  static auto remove(T*& root, T* node) -> void;
+  static auto minimum(T* root) -> T*;
+  static auto maximum(T* root) -> T*;
+  static auto successor(T* node) -> T*;
+  static auto getHeight(T* node) -> int;
+  // Recalcula `hl`/`hr` de `node` y, si quedó desbalanceado, lo rota.
+  static auto rebalance(T*& root, T* node) -> void;
+  // Aplica `rebalance` desde `node` hasta la raíz.
+  static auto fixup(T*& root, T* node) -> void;
+  // Verifica que las alturas guardadas sean las reales, que ningún nodo tenga
+  // factor de balance mayor a 1 y que los `parent` sean consistentes. Es
+  // `O(n)`, pensado para tests.
+  static auto isValid(T* root) -> bool;
+
+ private:
+  static auto checkedHeight(T* node, T* parent) -> int;
+  static auto resetLinks(T* node) -> void;
+  static auto leftRotation(T*& root, T* x, T* y) -> void;
+  static auto rightRotation(T*& root, T* x, T* y) -> void;
+  static auto replaceChild(T*& root, T* parent, T* oldChild, T* newChild)
+      -> void;
+};
+
+template <typename T, typename Hook>
+template <typename Compare>
+auto AVLAlgorithms<T, Hook>::insert(T*& root, T* node, const Compare& compare)
+    -> void {
+  resetLinks(node);
+  if (root == nullptr) {
+    root = node;
+    return;
+  }
+  T* parent = nullptr;
+  T* current = root;
+  int comp = AVL_EQUAL;
+  while (current) {
+    parent = current;
+    comp = compare(node, current);
+    if (comp == AVL_GREATER) {
+      current = Hook::of(current).right;
+    } else if (comp == AVL_LESS) {
+      current = Hook::of(current).left;
+    } else {
+      throw "duplicate key";
+    }
+  }
+  if (comp == AVL_GREATER) {
+    Hook::of(parent).right = node;
+  } else {
+    Hook::of(parent).left = node;
+  }
+  Hook::of(node).parent = parent;
+  fixup(root, parent);
+}
+
+template <typename T, typename Hook>
+template <typename Probe>
+auto AVLAlgorithms<T, Hook>::find(T* root, const Probe& probe) -> T* {
+  T* current = root;
+  while (current) {
+    int comp = probe(current);
+    if (comp == AVL_EQUAL) {
+      return current;
+    }
+    if (comp == AVL_GREATER) {
+      current = Hook::of(current).right;
+    } else {
+      current = Hook::of(current).left;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::remove(T*& root, T* node) -> void {
+  auto& hook = Hook::of(node);
+  T* parent = hook.parent;
+  T* rebalanceFrom = nullptr;
+  if (hook.left == nullptr || hook.right == nullptr) {
+    // node has at most one child
+    T* child = hook.left ? hook.left : hook.right;
+    replaceChild(root, parent, node, child);
+    if (child) {
+      Hook::of(child).parent = parent;
+    }
+    rebalanceFrom = parent;
+  } else {
+    // node has two children: the successor takes its place in the tree
+    T* replacement = minimum(hook.right);
+    auto& replacementHook = Hook::of(replacement);
+    if (replacementHook.parent == node) {
+      rebalanceFrom = replacement;
+    } else {
+      rebalanceFrom = replacementHook.parent;
+      Hook::of(rebalanceFrom).left = replacementHook.right;
+      if (replacementHook.right) {
+        Hook::of(replacementHook.right).parent = rebalanceFrom;
+      }
+      replacementHook.right = hook.right;
+      Hook::of(hook.right).parent = replacement;
+    }
+    replacementHook.left = hook.left;
+    Hook::of(hook.left).parent = replacement;
+    replaceChild(root, parent, node, replacement);
+    replacementHook.parent = parent;
+  }
+  resetLinks(node);
+  fixup(root, rebalanceFrom);
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::minimum(T* root) -> T* {
+  if (root == nullptr) {
+    return nullptr;
+  }
+  while (Hook::of(root).left != nullptr) {
+    root = Hook::of(root).left;
+  }
+  return root;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::maximum(T* root) -> T* {
+  if (root == nullptr) {
+    return nullptr;
+  }
+  while (Hook::of(root).right != nullptr) {
+    root = Hook::of(root).right;
+  }
+  return root;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::successor(T* node) -> T* {
+  if (Hook::of(node).right) {
+    return minimum(Hook::of(node).right);
+  }
+  T* y = Hook::of(node).parent;
+  while (y != nullptr && node == Hook::of(y).right) {
+    node = y;
+    y = Hook::of(y).parent;
+  }
+  return y;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::getHeight(T* node) -> int {
+  if (node == nullptr) {
+    return 0;
+  }
+  return std::max({Hook::of(node).hl, Hook::of(node).hr}) + 1;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::isValid(T* root) -> bool {
+  return checkedHeight(root, nullptr) >= 0;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::checkedHeight(T* node, T* parent) -> int {
+  // retorna la altura real de `node`, o -1 si su subárbol no es un AVL válido
+  if (node == nullptr) {
+    return 0;
+  }
+  auto& hook = Hook::of(node);
+  if (hook.parent != parent) {
+    return -1;
+  }
+  int hl = checkedHeight(hook.left, node);
+  int hr = checkedHeight(hook.right, node);
+  if (hl < 0 || hr < 0 || hook.hl != hl || hook.hr != hr || hl - hr > 1 ||
+      hr - hl > 1) {
+    return -1;
+  }
+  return std::max(hl, hr) + 1;
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::rebalance(T*& root, T* node) -> void {
+  auto& hook = Hook::of(node);
+  hook.hl = getHeight(hook.left);
+  hook.hr = getHeight(hook.right);
+  int balanceFactor = hook.hl - hook.hr;
+
+  if (balanceFactor < -1) {
+    // right heavy
+    auto& rightHook = Hook::of(hook.right);
+    int balanceFactorRight = rightHook.hl - rightHook.hr;
+    if (balanceFactorRight > 0) {
+      // RL rotation
+      rightRotation(root, hook.right, rightHook.left);
+      leftRotation(root, node, hook.right);
+    } else {
+      // L rotation
+      leftRotation(root, node, hook.right);
+    }
+  } else if (balanceFactor > 1) {
+    // left heavy
+    auto& leftHook = Hook::of(hook.left);
+    int balanceFactorLeft = leftHook.hl - leftHook.hr;
+    if (balanceFactorLeft < 0) {
+      // LR rotation
+      leftRotation(root, hook.left, leftHook.right);
+      rightRotation(root, node, hook.left);
+    } else {
+      // R rotation
+      rightRotation(root, node, hook.left);
+    }
+  }
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::fixup(T*& root, T* node) -> void {
+  while (node != nullptr) {
+    T* nextParent = Hook::of(node).parent;
+    rebalance(root, node);
+    node = nextParent;
+  }
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::leftRotation(T*& root, T* x, T* y) -> void {
+  auto& xHook = Hook::of(x);
+  auto& yHook = Hook::of(y);
+  if (yHook.left) {
+    Hook::of(yHook.left).parent = x;
+  }
+  xHook.right = yHook.left;
+  replaceChild(root, xHook.parent, x, y);
+  yHook.left = x;
+  yHook.parent = xHook.parent;
+  xHook.parent = y;
+
+  xHook.hr = getHeight(xHook.right);
+  yHook.hl = getHeight(yHook.left);
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::rightRotation(T*& root, T* x, T* y) -> void {
+  auto& xHook = Hook::of(x);
+  auto& yHook = Hook::of(y);
+  if (yHook.right) {
+    Hook::of(yHook.right).parent = x;
+  }
+  xHook.left = yHook.right;
+  replaceChild(root, xHook.parent, x, y);
+  yHook.right = x;
+  yHook.parent = xHook.parent;
+  xHook.parent = y;
+
+  xHook.hl = getHeight(xHook.left);
+  yHook.hr = getHeight(yHook.right);
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::replaceChild(T*& root,
+                                          T* parent,
+                                          T* oldChild,
+                                          T* newChild) -> void {
+  if (parent == nullptr) {
+    root = newChild;
+  } else if (Hook::of(parent).left == oldChild) {
+    Hook::of(parent).left = newChild;
+  } else {
+    Hook::of(parent).right = newChild;
+  }
+}
+
+template <typename T, typename Hook>
+auto AVLAlgorithms<T, Hook>::resetLinks(T* node) -> void {
+  auto& hook = Hook::of(node);
+  hook.left = nullptr;
+  hook.right = nullptr;
+  hook.parent = nullptr;
+  hook.hl = 0;
+  hook.hr = 0;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "avlhook.cpp"
+
+// AVL intrusivo: los enlaces viven en el miembro `Hook` de los objetos del
+// usuario, así que insertar y remover nunca reservan memoria. El AVL no es
+// dueño de los objetos; cada objeto debe seguir vivo mientras esté enlazado y
+// solo puede estar en un árbol por cada hook que tenga.
+//
+// `KeyOf` es un functor que recibe un `const T&` y devuelve su llave.
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+class IntrusiveAVL {
+ public:
+  using KeyType = std::remove_cvref_t<std::invoke_result_t<KeyOf, const T&>>;
+
+ private:
+  using Algorithms = AVLAlgorithms<T, MemberHook<T, Hook>>;
+
+  T* root;
+  size_t count;
+  KeyOf keyOf;
+  std::function<int(const KeyType&, const KeyType&)> comparator;
+
+ public:
+  // `comparator` sigue la misma convención que el del `AVL`.
+  explicit IntrusiveAVL(
+      const std::function<int(const KeyType&, const KeyType&)>& _comparator,
+      KeyOf _keyOf = KeyOf{});
+  IntrusiveAVL(const IntrusiveAVL&) = delete;
+  auto operator=(const IntrusiveAVL&) -> IntrusiveAVL& = delete;
+  IntrusiveAVL(IntrusiveAVL&&) = delete;
+  auto operator=(IntrusiveAVL&&) -> IntrusiveAVL& = delete;
+  [[nodiscard]] auto getHeight() const -> int;
+  [[nodiscard]] auto size() const -> size_t;
+  // Enlaza `object`. Lanza `"duplicate key"` si su llave ya está y
+  // `"object already linked"` si su hook ya está en uso, en este u otro árbol
+  // (salvo que sea la única raíz de otro árbol, que no se puede distinguir de
+  // un objeto desenlazado).
+  auto insert(T* object) -> void;
+  // Desenlaza `object` en `O(lg n)`, sin buscarlo por llave. Lanza
+  // `"object not linked"` si `object` no está en este árbol.
+  auto remove(T* object) -> void;
+  // Retorna si `object` está enlazado en este árbol y no en otro con el mismo
+  // hook; sube por los `parent` hasta la raíz, `O(lg n)`.
+  [[nodiscard]] auto isLinked(T* object) const -> bool;
+  auto find(const KeyType& key) const -> T*;
+  auto minimum() const -> T*;
+  auto maximum() const -> T*;
+  auto successor(T* object) const -> T*;
+  auto inorder(const std::function<void(T&)>& process) const -> void;
+  // Desenlaza todos los objetos sin destruirlos.
+  auto clear() -> void;
+  // Verifica las alturas, el balance y los `parent` de todo el árbol, `O(n)`.
+  [[nodiscard]] auto isValid() const -> bool;
+
+ private:
+  auto unlinkAll(T* _root) -> void;
+  [[nodiscard]] auto hookInUse(T* object) const -> bool;
+};
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+IntrusiveAVL<T, Hook, KeyOf>::IntrusiveAVL(
+    const std::function<int(const KeyType&, const KeyType&)>& _comparator,
+    KeyOf _keyOf)
+    : root{nullptr}, count{0}, keyOf{_keyOf}, comparator{_comparator} {}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::getHeight() const -> int {
+  return Algorithms::getHeight(root);
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::size() const -> size_t {
+  return count;
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::insert(T* object) -> void {
+  if (hookInUse(object)) {
+    throw "object already linked";
+  }
+  Algorithms::insert(root, object, [this](const T* a, const T* b) {
+    return comparator(keyOf(*a), keyOf(*b));
+  });
+  ++count;
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::remove(T* object) -> void {
+  if (!isLinked(object)) {
+    throw "object not linked";
+  }
+  Algorithms::remove(root, object);
+  --count;
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::isLinked(T* object) const -> bool {
+  // otro árbol con el mismo hook también deja `parent` en el objeto: solo la
+  // raíz a la que se llega dice en qué árbol está
+  T* top = object;
+  while ((top->*Hook).parent != nullptr) {
+    top = (top->*Hook).parent;
+  }
+  return top == root && root != nullptr;
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::find(const KeyType& key) const -> T* {
+  return Algorithms::find(root, [this, &key](const T* object) {
+    return comparator(key, keyOf(*object));
+  });
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::minimum() const -> T* {
+  return Algorithms::minimum(root);
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::maximum() const -> T* {
+  return Algorithms::maximum(root);
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::successor(T* object) const -> T* {
+  return Algorithms::successor(object);
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::inorder(
+    const std::function<void(T&)>& process) const -> void {
+  for (T* object = Algorithms::minimum(root); object != nullptr;
+       object = Algorithms::successor(object)) {
+    process(*object);
+  }
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::clear() -> void {
+  unlinkAll(root);
+  root = nullptr;
+  count = 0;
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::isValid() const -> bool {
+  return Algorithms::isValid(root);
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::unlinkAll(T* _root) -> void {
+  if (_root == nullptr) {
+    return;
+  }
+  unlinkAll((_root->*Hook).left);
+  unlinkAll((_root->*Hook).right);
+  _root->*Hook = AVLHook<T>{};
+}
+
+template <typename T, AVLHook<T> T::*Hook, typename KeyOf>
+auto IntrusiveAVL<T, Hook, KeyOf>::hookInUse(T* object) const -> bool {
+  const AVLHook<T>& hook = object->*Hook;
+  return object == root || hook.parent != nullptr || hook.left != nullptr ||
+         hook.right != nullptr;
+}
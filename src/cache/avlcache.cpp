@@ -0,0 +1,286 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+#include "../avl/avlhook.cpp"
+
+struct CacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+  size_t expirations = 0;
+};
+
+// Cada entrada vive en una sola reserva de memoria: el `key`-`value`, los
+// enlaces del índice por `key`, los del índice por tiempo de expiración y los
+// de la lista LRU.
+template <typename KeyType, typename ValueType, typename TimePoint>
+struct CacheEntry {
+  KeyType key;
+  ValueType value;
+  TimePoint expiresAt;
+  AVLHook<CacheEntry> keyHook;
+  AVLHook<CacheEntry> expiryHook;
+  CacheEntry* lruPrev;
+  CacheEntry* lruNext;
+
+  explicit CacheEntry(const KeyType& _key,
+                      const ValueType& _value,
+                      TimePoint _expiresAt)
+      : key{_key},
+        value{_value},
+        expiresAt{_expiresAt},
+        lruPrev{nullptr},
+        lruNext{nullptr} {}
+};
+
+// Cache LRU con TTL respaldado por dos AVL intrusivos: uno ordenado por `key`
+// y otro por tiempo de expiración, cuyo `minimum` es la siguiente entrada en
+// expirar.
+template <typename KeyType,
+          typename ValueType,
+          typename Clock = std::chrono::steady_clock>
+class AVLCache {
+  using TimePoint = typename Clock::time_point;
+  using Entry = CacheEntry<KeyType, ValueType, TimePoint>;
+  using KeyIndex = AVLAlgorithms<Entry, MemberHook<Entry, &Entry::keyHook>>;
+  using ExpiryIndex =
+      AVLAlgorithms<Entry, MemberHook<Entry, &Entry::expiryHook>>;
+
+  Entry* keyRoot;
+  Entry* expiryRoot;
+  // `lruHead` es la entrada usada más recientemente, `lruTail` la menos
+  Entry* lruHead;
+  Entry* lruTail;
+  size_t entryCount;
+  size_t maxEntries;
+  CacheStats stats;
+  std::function<int(const KeyType&, const KeyType&)> comparator;
+
+ public:
+  // `comparator` sigue la misma convención que el del `AVL`. `capacity` es la
+  // cantidad máxima de entradas; al superarla se desaloja la menos usada.
+  AVLCache(size_t capacity,
+           const std::function<int(const KeyType&, const KeyType&)>&
+               _comparator);
+  AVLCache(const AVLCache&) = delete;
+  auto operator=(const AVLCache&) -> AVLCache& = delete;
+  AVLCache(AVLCache&&) = delete;
+  auto operator=(AVLCache&&) -> AVLCache& = delete;
+  // Devuelve el `value` si el `key` está y no expiró, y lo marca como el más
+  // recientemente usado.
+  auto get(const KeyType& key, TimePoint now = Clock::now())
+      -> std::optional<ValueType>;
+  // Inserta o reemplaza un `key`-`value` pair. Sin `ttl`, la entrada no
+  // expira y solo sale del cache por capacidad o con `remove`.
+  auto put(const KeyType& key,
+           const ValueType& value,
+           std::optional<typename Clock::duration> ttl = {},
+           TimePoint now = Clock::now()) -> void;
+  auto remove(const KeyType& key) -> void;
+  // Borra todas las entradas que expiraron hasta `now` y retorna cuántas.
+  auto expire(TimePoint now = Clock::now()) -> size_t;
+  [[nodiscard]] auto size() const -> size_t;
+  [[nodiscard]] auto capacity() const -> size_t;
+  [[nodiscard]] auto getStats() const -> CacheStats;
+  ~AVLCache() noexcept;
+
+ private:
+  auto findEntry(const KeyType& key) const -> Entry*;
+  auto erase(Entry* entry) -> void;
+  auto lruPushFront(Entry* entry) -> void;
+  auto lruUnlink(Entry* entry) -> void;
+  auto compareKeys(const Entry* a, const Entry* b) const -> int;
+  static auto compareExpiry(const Entry* a, const Entry* b) -> int;
+};
+
+template <typename KeyType, typename ValueType, typename Clock>
+AVLCache<KeyType, ValueType, Clock>::AVLCache(
+    size_t capacity,
+    const std::function<int(const KeyType&, const KeyType&)>& _comparator)
+    : keyRoot{nullptr},
+      expiryRoot{nullptr},
+      lruHead{nullptr},
+      lruTail{nullptr},
+      entryCount{0},
+      maxEntries{capacity},
+      comparator{_comparator} {}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::get(const KeyType& key,
+                                              TimePoint now)
+    -> std::optional<ValueType> {
+  Entry* entry = findEntry(key);
+  if (entry == nullptr) {
+    ++stats.misses;
+    return {};
+  }
+  if (entry->expiresAt <= now) {
+    erase(entry);
+    ++stats.expirations;
+    ++stats.misses;
+    return {};
+  }
+  ++stats.hits;
+  if (entry != lruHead) {
+    lruUnlink(entry);
+    lruPushFront(entry);
+  }
+  return entry->value;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::put(
+    const KeyType& key,
+    const ValueType& value,
+    std::optional<typename Clock::duration> ttl,
+    TimePoint now) -> void {
+  TimePoint expiresAt = ttl ? now + ttl.value() : TimePoint::max();
+  Entry* entry = findEntry(key);
+  if (entry) {
+    entry->value = value;
+    if (entry->expiresAt != expiresAt) {
+      ExpiryIndex::remove(expiryRoot, entry);
+      entry->expiresAt = expiresAt;
+      ExpiryIndex::insert(expiryRoot, entry, compareExpiry);
+    }
+    if (entry != lruHead) {
+      lruUnlink(entry);
+      lruPushFront(entry);
+    }
+    return;
+  }
+  if (maxEntries == 0) {
+    return;
+  }
+  if (entryCount == maxEntries) {
+    // preferir liberar entradas expiradas antes que desalojar por LRU
+    if (expire(now) == 0) {
+      erase(lruTail);
+      ++stats.evictions;
+    }
+  }
+  entry = new Entry(key, value, expiresAt);
+  KeyIndex::insert(keyRoot, entry, [this](const Entry* a, const Entry* b) {
+    return compareKeys(a, b);
+  });
+  ExpiryIndex::insert(expiryRoot, entry, compareExpiry);
+  lruPushFront(entry);
+  ++entryCount;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::remove(const KeyType& key) -> void {
+  Entry* entry = findEntry(key);
+  if (entry) {
+    erase(entry);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::expire(TimePoint now) -> size_t {
+  size_t expired = 0;
+  Entry* oldest = ExpiryIndex::minimum(expiryRoot);
+  while (oldest && oldest->expiresAt <= now) {
+    erase(oldest);
+    ++expired;
+    oldest = ExpiryIndex::minimum(expiryRoot);
+  }
+  stats.expirations += expired;
+  return expired;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::size() const -> size_t {
+  return entryCount;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::capacity() const -> size_t {
+  return maxEntries;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::getStats() const -> CacheStats {
+  return stats;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::findEntry(const KeyType& key) const
+    -> Entry* {
+  return KeyIndex::find(keyRoot, [this, &key](const Entry* entry) {
+    return comparator(key, entry->key);
+  });
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::erase(Entry* entry) -> void {
+  KeyIndex::remove(keyRoot, entry);
+  ExpiryIndex::remove(expiryRoot, entry);
+  lruUnlink(entry);
+  --entryCount;
+  delete entry;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::lruPushFront(Entry* entry) -> void {
+  entry->lruPrev = nullptr;
+  entry->lruNext = lruHead;
+  if (lruHead) {
+    lruHead->lruPrev = entry;
+  } else {
+    lruTail = entry;
+  }
+  lruHead = entry;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::lruUnlink(Entry* entry) -> void {
+  if (entry->lruPrev) {
+    entry->lruPrev->lruNext = entry->lruNext;
+  } else {
+    lruHead = entry->lruNext;
+  }
+  if (entry->lruNext) {
+    entry->lruNext->lruPrev = entry->lruPrev;
+  } else {
+    lruTail = entry->lruPrev;
+  }
+  entry->lruPrev = nullptr;
+  entry->lruNext = nullptr;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::compareKeys(const Entry* a,
+                                                      const Entry* b) const
+    -> int {
+  return comparator(a->key, b->key);
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+auto AVLCache<KeyType, ValueType, Clock>::compareExpiry(const Entry* a,
+                                                        const Entry* b)
+    -> int {
+  // varias entradas pueden expirar en el mismo instante: se desempata por
+  // dirección para que el índice no tenga llaves duplicadas
+  if (a->expiresAt != b->expiresAt) {
+    return a->expiresAt < b->expiresAt ? AVL_LESS : AVL_GREATER;
+  }
+  if (a == b) {
+    return AVL_EQUAL;
+  }
+  return std::less<const Entry*>{}(a, b) ? AVL_LESS : AVL_GREATER;
+}
+
+template <typename KeyType, typename ValueType, typename Clock>
+AVLCache<KeyType, ValueType, Clock>::~AVLCache() noexcept {
+  Entry* entry = lruHead;
+  while (entry) {
+    Entry* next = entry->lruNext;
+    delete entry;
+    entry = next;
+  }
+}
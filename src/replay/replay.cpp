@@ -0,0 +1,253 @@
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "../avl/avl.cpp"
+#include "../avl/intrusiveavl.cpp"
+#include "../trace/trace.hpp"
+
+// Reproduce un trace grabado con `TraceRecorder` contra una variante del AVL,
+// operación por operación y sin pausas (los timestamps grabados se ignoran),
+// así dos corridas sobre el mismo trace hacen exactamente el mismo trabajo.
+//
+// Uso: ./avlreplay <trace> [avl | avl-iterative | intrusive]
+
+namespace {
+const char* OP_NAMES[] = {"insert", "remove", "find"};
+const size_t OP_COUNT = 3;
+
+auto compareKeys(const int64_t& a, const int64_t& b) -> int {
+  if (a == b) {
+    return 0;
+  } else if (a < b) {
+    return -1;
+  } else {
+    return 1;
+  }
+}
+
+struct ReplayNode {
+  int64_t key;
+  int64_t value;
+  AVLHook<ReplayNode> hook;
+};
+
+struct ReplayNodeKey {
+  auto operator()(const ReplayNode& node) const -> const int64_t& {
+    return node.key;
+  }
+};
+
+// Adaptan cada variante a la misma interfaz para `replay`.
+struct RecursiveVariant {
+  AVL<int64_t, int64_t> tree{compareKeys};
+
+  auto insert(int64_t key) -> void { tree.insert(key, key); }
+  auto remove(int64_t key) -> void { tree.remove(key); }
+  auto find(int64_t key) -> bool { return tree.find(key).has_value(); }
+  [[nodiscard]] auto getHeight() const -> int { return tree.getHeight(); }
+};
+
+struct IterativeVariant {
+  AVL<int64_t, int64_t> tree{compareKeys};
+
+  auto insert(int64_t key) -> void { tree.iterativeInsert(key, key); }
+  auto remove(int64_t key) -> void { tree.remove(key); }
+  auto find(int64_t key) -> bool {
+    return tree.iterativeFindKey(key).has_value();
+  }
+  [[nodiscard]] auto getHeight() const -> int { return tree.getHeight(); }
+};
+
+struct IntrusiveVariant {
+  IntrusiveAVL<ReplayNode, &ReplayNode::hook, ReplayNodeKey> tree{
+      compareKeys};
+  // los objetos viven fuera del árbol, como en un uso real; los removidos se
+  // reutilizan para que la memoria siga al tamaño del árbol y no al total de
+  // `insert`s del trace
+  std::deque<ReplayNode> nodes;
+  std::vector<ReplayNode*> freeNodes;
+
+  auto insert(int64_t key) -> void {
+    bool recycled = !freeNodes.empty();
+    ReplayNode* node = nullptr;
+    if (recycled) {
+      node = freeNodes.back();
+      freeNodes.pop_back();
+      node->key = key;
+      node->value = key;
+    } else {
+      nodes.push_back(ReplayNode{key, key, {}});
+      node = &nodes.back();
+    }
+    try {
+      tree.insert(node);
+    } catch (const char* /*error*/) {
+      // llave duplicada: el nodo nunca quedó enlazado
+      if (recycled) {
+        freeNodes.push_back(node);
+      } else {
+        nodes.pop_back();
+      }
+      throw;
+    }
+  }
+  auto remove(int64_t key) -> void {
+    ReplayNode* node = tree.find(key);
+    if (node) {
+      tree.remove(node);
+      freeNodes.push_back(node);
+    }
+  }
+  auto find(int64_t key) -> bool { return tree.find(key) != nullptr; }
+  [[nodiscard]] auto getHeight() const -> int { return tree.getHeight(); }
+};
+
+// RSS actual del proceso, a diferencia de `ru_maxrss` que es el pico
+auto currentRssKiB() -> long {
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0;
+  }
+  long pages = 0;
+  long residentPages = 0;
+  if (std::fscanf(statm, "%ld %ld", &pages, &residentPages) != 2) {
+    residentPages = 0;
+  }
+  std::fclose(statm);
+  return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+auto percentile(const std::vector<uint64_t>& sorted, double p) -> uint64_t {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+template <typename Variant>
+auto replay(const TraceReader& trace, Variant& variant) -> void {
+  // una pasada previa cuenta cada operación para reservar exactamente lo que
+  // se va a medir; `resize` toca las páginas ahora, así no cuentan en la
+  // memoria del replay
+  size_t opCounts[OP_COUNT] = {};
+  size_t invalid = 0;
+  for (const TraceRecord& record : trace) {
+    auto op = static_cast<size_t>(record.op());
+    if (op < OP_COUNT) {
+      ++opCounts[op];
+    } else {
+      // byte de operación corrupto
+      ++invalid;
+    }
+  }
+  std::vector<uint64_t> latencies[OP_COUNT];
+  size_t measured[OP_COUNT] = {};
+  for (size_t op = 0; op < OP_COUNT; ++op) {
+    latencies[op].resize(opCounts[op]);
+  }
+  size_t failed = 0;
+  size_t found = 0;
+  long rssBeforeKiB = currentRssKiB();
+
+  auto start = std::chrono::steady_clock::now();
+  for (const TraceRecord& record : trace) {
+    auto op = static_cast<size_t>(record.op());
+    if (op >= OP_COUNT) {
+      continue;
+    }
+    auto opStart = std::chrono::steady_clock::now();
+    try {
+      switch (record.op()) {
+        case TraceOp::Insert:
+          variant.insert(record.key);
+          break;
+        case TraceOp::Remove:
+          variant.remove(record.key);
+          break;
+        case TraceOp::Find:
+          if (variant.find(record.key)) {
+            ++found;
+          }
+          break;
+        default:
+          break;
+      }
+    } catch (const char* /*error*/) {
+      // p. ej. un `insert` duplicado que también falló al grabarse
+      ++failed;
+    }
+    auto opEnd = std::chrono::steady_clock::now();
+    latencies[op][measured[op]++] = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(opEnd - opStart)
+            .count());
+  }
+  auto end = std::chrono::steady_clock::now();
+  double seconds =
+      std::chrono::duration_cast<std::chrono::duration<double>>(end - start)
+          .count();
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+
+  printf("ops: %zu (failed: %zu, invalid: %zu, finds hit: %zu)\n",
+         trace.size(), failed, invalid, found);
+  printf("throughput: %.0f ops/s (%lf seconds)\n",
+         static_cast<double>(trace.size()) / seconds, seconds);
+  printf("%-8s %10s %10s %10s %10s %10s %10s\n", "op", "count", "p50 ns",
+         "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+  for (size_t op = 0; op < OP_COUNT; ++op) {
+    std::vector<uint64_t>& opLatencies = latencies[op];
+    std::sort(opLatencies.begin(), opLatencies.end());
+    printf("%-8s %10zu %10lu %10lu %10lu %10lu %10lu\n", OP_NAMES[op],
+           opLatencies.size(), percentile(opLatencies, 0.5),
+           percentile(opLatencies, 0.9), percentile(opLatencies, 0.99),
+           percentile(opLatencies, 0.999),
+           opLatencies.empty() ? 0UL : opLatencies.back());
+  }
+  // crecimiento del pico de RSS respecto de antes del replay: excluye el
+  // binario, el trace mapeado y los buffers de latencias
+  printf("peak memory: %ld KiB\n", usage.ru_maxrss - rssBeforeKiB);
+  printf("tree height: %d\n", variant.getHeight());
+}
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  if (argc < 2 || argc > 3) {
+    fprintf(stderr, "usage: %s <trace> [avl | avl-iterative | intrusive]\n",
+            argv[0]);
+    return 1;
+  }
+  std::string variantName = argc == 3 ? argv[2] : "avl";
+  if (variantName != "avl" && variantName != "avl-iterative" &&
+      variantName != "intrusive") {
+    fprintf(stderr, "unknown variant: %s\n", variantName.c_str());
+    return 1;
+  }
+  try {
+    TraceReader trace(argv[1]);
+    printf("trace: %s, variant: %s\n", argv[1], variantName.c_str());
+    if (variantName == "avl") {
+      RecursiveVariant variant;
+      replay(trace, variant);
+    } else if (variantName == "avl-iterative") {
+      IterativeVariant variant;
+      replay(trace, variant);
+    } else {
+      IntrusiveVariant variant;
+      replay(trace, variant);
+    }
+  } catch (const char* error) {
+    fprintf(stderr, "%s\n", error);
+    return 1;
+  }
+  return 0;
+}
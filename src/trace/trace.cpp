@@ -0,0 +1,130 @@
+#include "trace.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace {
+const char TRACE_MAGIC[8] = {'A', 'V', 'L', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t TRACE_VERSION = 1;
+const size_t TRACE_BUFFER_RECORDS = 4096;
+
+struct TraceHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+};
+}  // namespace
+
+TraceRecorder::TraceRecorder(const char* path)
+    : file{std::fopen(path, "wb")},
+      start{std::chrono::steady_clock::now()},
+      writeFailed{false} {
+  if (file == nullptr) {
+    throw "could not open trace file";
+  }
+  TraceHeader header{};
+  std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+  header.version = TRACE_VERSION;
+  header.recordSize = sizeof(TraceRecord);
+  if (std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+      std::fflush(file) != 0) {
+    std::fclose(file);
+    throw "could not write trace file";
+  }
+  buffer.reserve(TRACE_BUFFER_RECORDS);
+}
+
+auto TraceRecorder::record(TraceOp op, int64_t key) -> void {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (writeFailed) {
+    throw "could not write trace file";
+  }
+  // el timestamp se toma con el lock para que el trace quede ordenado
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  buffer.push_back(TraceRecord{
+      (static_cast<uint64_t>(elapsed.count()) << 8U) | static_cast<uint8_t>(op),
+      key});
+  if (buffer.size() == TRACE_BUFFER_RECORDS && !writeBuffer()) {
+    throw "could not write trace file";
+  }
+}
+
+auto TraceRecorder::flush() -> void {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (writeFailed || !writeBuffer()) {
+    throw "could not write trace file";
+  }
+}
+
+TraceRecorder::~TraceRecorder() noexcept {
+  if (!writeFailed && !writeBuffer()) {
+    std::fputs("could not write trace file, the trace is truncated\n",
+               stderr);
+  }
+  std::fclose(file);
+}
+
+auto TraceRecorder::writeBuffer() -> bool {
+  size_t written =
+      std::fwrite(buffer.data(), sizeof(TraceRecord), buffer.size(), file);
+  if (written != buffer.size() || std::fflush(file) != 0) {
+    writeFailed = true;
+  }
+  buffer.clear();
+  return !writeFailed;
+}
+
+TraceReader::TraceReader(const char* path)
+    : records{nullptr}, count{0}, mapping{nullptr}, mappingSize{0} {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    throw "could not open trace file";
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(TraceHeader)) {
+    close(fd);
+    throw "invalid trace file";
+  }
+  mappingSize = static_cast<size_t>(info.st_size);
+  // MAP_POPULATE carga todas las páginas ahora y no durante el replay
+  mapping =
+      mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    throw "could not open trace file";
+  }
+  const auto* header = static_cast<const TraceHeader*>(mapping);
+  // un registro cortado a la mitad es una escritura que quedó truncada
+  if (std::memcmp(header->magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 ||
+      header->version != TRACE_VERSION ||
+      header->recordSize != sizeof(TraceRecord) ||
+      (mappingSize - sizeof(TraceHeader)) % sizeof(TraceRecord) != 0) {
+    munmap(mapping, mappingSize);
+    throw "invalid trace file";
+  }
+  records = reinterpret_cast<const TraceRecord*>(  // NOLINT
+      static_cast<const char*>(mapping) + sizeof(TraceHeader));
+  count = (mappingSize - sizeof(TraceHeader)) / sizeof(TraceRecord);
+}
+
+auto TraceReader::size() const -> size_t {
+  return count;
+}
+
+auto TraceReader::begin() const -> const TraceRecord* {
+  return records;
+}
+
+auto TraceReader::end() const -> const TraceRecord* {
+  return records + count;
+}
+
+TraceReader::~TraceReader() noexcept {
+  munmap(mapping, mappingSize);
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+enum class TraceOp : uint8_t { Insert = 0, Remove = 1, Find = 2 };
+
+// Cada operación ocupa 16 bytes: 56 bits de timestamp (nanosegundos desde
+// que se creó el `TraceRecorder`), 8 bits de operación y el `key`.
+struct TraceRecord {
+  uint64_t timestampAndOp;
+  int64_t key;
+
+  [[nodiscard]] auto timestamp() const -> uint64_t {
+    return timestampAndOp >> 8U;
+  }
+  [[nodiscard]] auto op() const -> TraceOp {
+    return static_cast<TraceOp>(timestampAndOp & 0xFFU);
+  }
+};
+
+// Escribe un log binario de operaciones: una cabecera con `TRACE_MAGIC` y
+// `TRACE_VERSION` seguida de `TraceRecord`s. Los registros se acumulan en
+// memoria y se escriben en bloques. `record` y `flush` se pueden llamar desde
+// varios hilos a la vez.
+class TraceRecorder {
+  std::FILE* file;
+  std::vector<TraceRecord> buffer;
+  std::chrono::steady_clock::time_point start;
+  std::mutex mutex;
+  bool writeFailed;
+
+ public:
+  // Lanza `"could not open trace file"` si no puede crear `path` y
+  // `"could not write trace file"` si no puede escribir la cabecera.
+  explicit TraceRecorder(const char* path);
+  TraceRecorder(const TraceRecorder&) = delete;
+  auto operator=(const TraceRecorder&) -> TraceRecorder& = delete;
+  TraceRecorder(TraceRecorder&&) = delete;
+  auto operator=(TraceRecorder&&) -> TraceRecorder& = delete;
+  // Ambas lanzan `"could not write trace file"` si falló la escritura de
+  // algún bloque (p. ej. disco lleno), ahora o en una llamada anterior: el
+  // trace ya quedó truncado.
+  auto record(TraceOp op, int64_t key) -> void;
+  auto flush() -> void;
+  // Si la última escritura falla, lo avisa por `stderr`.
+  ~TraceRecorder() noexcept;
+
+ private:
+  // Escribe `buffer` y lo vacía; retorna `false` si no se pudo escribir
+  // entero. Se llama con `mutex` tomado.
+  auto writeBuffer() -> bool;
+};
+
+// Lee un trace mapeándolo en memoria, así leerlo durante el replay no hace
+// I/O.
+class TraceReader {
+  const TraceRecord* records;
+  size_t count;
+  void* mapping;
+  size_t mappingSize;
+
+ public:
+  // Lanza `"could not open trace file"` o `"invalid trace file"`.
+  explicit TraceReader(const char* path);
+  TraceReader(const TraceReader&) = delete;
+  auto operator=(const TraceReader&) -> TraceReader& = delete;
+  TraceReader(TraceReader&&) = delete;
+  auto operator=(TraceReader&&) -> TraceReader& = delete;
+  [[nodiscard]] auto size() const -> size_t;
+  [[nodiscard]] auto begin() const -> const TraceRecord*;
+  [[nodiscard]] auto end() const -> const TraceRecord*;
+  ~TraceReader() noexcept;
+};
@@ -0,0 +1,125 @@
+#include "threadpool.hpp"
+
+namespace {
+// worker del pool actual que corre en este hilo, para que `submit` use su cola
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : queuedTasks{0}, unfinishedTasks{0}, nextQueue{0}, stopping{false} {
+  if (threadCount == 0) {
+    threadCount = 1;
+  }
+  for (size_t i = 0; i < threadCount; ++i) {
+    queues.emplace_back(std::make_unique<WorkQueue>());
+  }
+  for (size_t i = 0; i < threadCount; ++i) {
+    workers.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+auto ThreadPool::submit(std::function<void()> task) -> void {
+  std::unique_lock<std::mutex> lock(stateMutex);
+  size_t index = currentPool == this ? currentQueue
+                                     : nextQueue++ % queues.size();
+  {
+    std::lock_guard<std::mutex> queueLock(queues[index]->mutex);
+    queues[index]->tasks.push_back(std::move(task));
+  }
+  ++queuedTasks;
+  ++unfinishedTasks;
+  lock.unlock();
+  taskAvailable.notify_one();
+}
+
+auto ThreadPool::wait() -> void {
+  std::unique_lock<std::mutex> lock(stateMutex);
+  allDone.wait(lock, [this]() { return unfinishedTasks == 0; });
+  if (firstException) {
+    std::exception_ptr exception = firstException;
+    firstException = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+auto ThreadPool::drain() noexcept -> void {
+  std::unique_lock<std::mutex> lock(stateMutex);
+  allDone.wait(lock, [this]() { return unfinishedTasks == 0; });
+  firstException = nullptr;
+}
+
+auto ThreadPool::threadCount() const -> size_t {
+  return workers.size();
+}
+
+ThreadPool::~ThreadPool() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    stopping = true;
+  }
+  taskAvailable.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+auto ThreadPool::workerLoop(size_t index) -> void {
+  currentPool = this;
+  currentQueue = index;
+  std::function<void()> task;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(stateMutex);
+      taskAvailable.wait(lock,
+                         [this]() { return stopping || queuedTasks > 0; });
+      if (queuedTasks == 0) {
+        // stopping y sin tareas pendientes
+        return;
+      }
+    }
+    if (!tryPop(index, task)) {
+      continue;
+    }
+    std::exception_ptr exception;
+    try {
+      task();
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    task = nullptr;
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (exception && !firstException) {
+      firstException = exception;
+    }
+    if (--unfinishedTasks == 0) {
+      allDone.notify_all();
+    }
+  }
+}
+
+auto ThreadPool::tryPop(size_t index, std::function<void()>& task) -> bool {
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    if (!queues[index]->tasks.empty()) {
+      task = std::move(queues[index]->tasks.back());
+      queues[index]->tasks.pop_back();
+      found = true;
+    }
+  }
+  for (size_t i = 1; !found && i < queues.size(); ++i) {
+    WorkQueue& victim = *queues[(index + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      found = true;
+    }
+  }
+  if (found) {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    --queuedTasks;
+  }
+  return found;
+}
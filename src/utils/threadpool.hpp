@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos con work stealing: cada worker tiene su propia cola, saca
+// tareas del final de la suya y, cuando se vacía, roba del inicio de las
+// demás.
+class ThreadPool {
+  struct WorkQueue {
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+  };
+
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex stateMutex;
+  std::condition_variable taskAvailable;
+  std::condition_variable allDone;
+  size_t queuedTasks;
+  size_t unfinishedTasks;
+  size_t nextQueue;
+  bool stopping;
+  std::exception_ptr firstException;
+
+ public:
+  explicit ThreadPool(size_t threadCount);
+  ThreadPool(const ThreadPool&) = delete;
+  auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+  // Las tareas enviadas desde un worker van a su propia cola.
+  auto submit(std::function<void()> task) -> void;
+  // Bloquea hasta que terminen todas las tareas enviadas y relanza la primera
+  // excepción que haya lanzado alguna. No debe llamarse desde un worker.
+  auto wait() -> void;
+  // Como `wait`, pero descarta la excepción de las tareas en vez de
+  // relanzarla; sirve para esperarlas mientras se propaga otra excepción.
+  auto drain() noexcept -> void;
+  [[nodiscard]] auto threadCount() const -> size_t;
+  ~ThreadPool() noexcept;
+
+ private:
+  auto workerLoop(size_t index) -> void;
+  auto tryPop(size_t index, std::function<void()>& task) -> bool;
+};
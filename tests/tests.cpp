@@ -1,14 +1,128 @@
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <list>
+#include <queue>
+#include <random>
+#include <string>
 #include <vector>
 
+#include "../src/async/scheduler.hpp"
 #include "../src/avl/avl.cpp"
+#include "../src/avl/intrusiveavl.cpp"
+#include "../src/cache/avlcache.cpp"
+#include "../src/trace/trace.hpp"
 #include "../src/utils/helpers.hpp"
 
 const int NODE_COUNT = 100000;
+// ~8M nodos de `AVL<int, int>` ocupan unos 380 MB, solo con `--bench`
+const int ASYNC_BENCH_NODE_COUNT = 1 << 23;
+const int ASYNC_NODE_COUNT = 1 << 12;
+const int ASYNC_LOOKUPS = 200000;
+const int CACHE_KEYS = 100000;
+const size_t CACHE_CAPACITY = 10000;
+const int CACHE_OPS = 500000;
+const size_t MAX_THREADS = 64;
 
-auto main() -> int {
+auto compareInts(const int& a, const int& b) -> int {
+  if (a == b) {
+    return 0;
+  } else if (a < b) {
+    return -1;
+  } else {
+    return 1;
+  }
+}
+
+struct Connection {
+  int fd;
+  std::string peer;
+  AVLHook<Connection> byFd;
+};
+
+struct ConnectionFd {
+  auto operator()(const Connection& connection) const -> const int& {
+    return connection.fd;
+  }
+};
+
+// Cache LRU con TTL armado con tres estructuras separadas (AVL, `std::list` y
+// un heap), para comparar contra `AVLCache`.
+class ThreeStructureCache {
+  using TimePoint = std::chrono::steady_clock::time_point;
+  using Entry = std::tuple<int, std::string, TimePoint>;
+
+  std::list<Entry> lru;
+  AVL<int, std::list<Entry>::iterator> index;
+  std::priority_queue<std::tuple<TimePoint, int>,
+                      std::vector<std::tuple<TimePoint, int>>,
+                      std::greater<>>
+      expiry;
+  size_t maxEntries;
+  size_t entryCount;
+
+ public:
+  explicit ThreeStructureCache(size_t capacity)
+      : index{compareInts}, maxEntries{capacity}, entryCount{0} {}
+
+  auto get(int key, TimePoint now) -> std::optional<std::string> {
+    auto it = index.find(key);
+    if (!it.has_value()) {
+      return {};
+    }
+    if (std::get<2>(*it.value()) <= now) {
+      lru.erase(it.value());
+      index.remove(key);
+      --entryCount;
+      return {};
+    }
+    lru.splice(lru.begin(), lru, it.value());
+    return std::get<1>(*it.value());
+  }
+
+  auto put(int key,
+           const std::string& value,
+           std::chrono::steady_clock::duration ttl,
+           TimePoint now) -> void {
+    auto it = index.find(key);
+    if (it.has_value()) {
+      *it.value() = std::make_tuple(key, value, now + ttl);
+      lru.splice(lru.begin(), lru, it.value());
+      expiry.emplace(now + ttl, key);
+      return;
+    }
+    if (entryCount == maxEntries) {
+      index.remove(std::get<0>(lru.back()));
+      lru.pop_back();
+      --entryCount;
+    }
+    lru.emplace_front(key, value, now + ttl);
+    index.insert(key, lru.begin());
+    expiry.emplace(now + ttl, key);
+    ++entryCount;
+  }
+
+  auto expire(TimePoint now) -> void {
+    while (!expiry.empty() && std::get<0>(expiry.top()) <= now) {
+      auto [expiresAt, key] = expiry.top();
+      expiry.pop();
+      auto it = index.find(key);
+      // el heap puede tener entradas viejas de un `key` que ya cambió
+      if (it.has_value() && std::get<2>(*it.value()) == expiresAt) {
+        lru.erase(it.value());
+        index.remove(key);
+        --entryCount;
+      }
+    }
+  }
+};
+
+// `./avltest --bench` además corre los benchmarks que necesitan árboles más
+// grandes que la caché de último nivel
+auto main(int argc, char** argv) -> int {
+  bool runBenchmarks = argc > 1 && std::string(argv[1]) == "--bench";
   auto* avl = new AVL<int, std::string>([](int a, int b) {
     if (a == b) {
       return 0;
@@ -67,6 +181,91 @@ auto main() -> int {
     }
   });
 
+  // async find tests
+  {
+    Scheduler scheduler;
+    std::vector<Task<std::optional<std::string>>> finds;
+    std::vector<Task<std::optional<int>>> findKeys;
+    finds.reserve(svec.size() + 1);
+    findKeys.reserve(svec.size());
+    for (auto s : svec) {
+      finds.emplace_back(avl->asyncFind(s));
+      findKeys.emplace_back(avl->asyncFindKey(s));
+      scheduler.schedule(finds.back().coroutine());
+      scheduler.schedule(findKeys.back().coroutine());
+    }
+    finds.emplace_back(avl->asyncFind(1));
+    scheduler.schedule(finds.back().coroutine());
+    scheduler.run();
+    for (size_t i = 0; i < svec.size(); ++i) {
+      assert(finds[i].result() == "bruh " + std::to_string(svec[i]));
+      assert(findKeys[i].result() == svec[i]);
+    }
+    assert(finds.back().result().has_value() == false);
+  }
+
+  // async range tests
+  {
+    std::string keys;
+    auto range = avl->asyncRange(
+        501, 520, [&keys](const int& key, const std::string& /*value*/) {
+          keys += std::to_string(key) + " ";
+        });
+    Scheduler scheduler;
+    scheduler.schedule(range.coroutine());
+    scheduler.run();
+    assert(range.result() == 10);
+    assert(keys == "502 504 506 508 510 512 514 516 518 520 ");
+  }
+
+  // async find tests: las mismas búsquedas con `find`, `iterativeFindKey` y
+  // `asyncFind` intercalando `depth` corrutinas a la vez. Con `--bench` el
+  // árbol ocupa más que la caché de último nivel, para que haya misses que
+  // ocultar.
+  {
+    int nodeCount = runBenchmarks ? ASYNC_BENCH_NODE_COUNT : ASYNC_NODE_COUNT;
+    AVL<int, int> bigAvl(compareInts);
+    for (int i = 0; i < nodeCount; ++i) {
+      bigAvl.iterativeInsert(i, i);
+    }
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, nodeCount - 1);
+    std::vector<int> lookups(ASYNC_LOOKUPS);
+    for (auto& key : lookups) {
+      key = dist(gen);
+    }
+    measureTime("big avl recursive find", [&bigAvl, &lookups]() {
+      for (auto key : lookups) {
+        assert(bigAvl.find(key).value() == key);
+      }
+    });
+    measureTime("big avl iterative find", [&bigAvl, &lookups]() {
+      for (auto key : lookups) {
+        assert(bigAvl.iterativeFindKey(key).value() == key);
+      }
+    });
+    for (size_t depth : std::vector<size_t>{1, 2, 4, 8, 16, 32}) {
+      std::string name =
+          "big avl async find (depth " + std::to_string(depth) + ")";
+      measureTime(name.c_str(), [&bigAvl, &lookups, depth]() {
+        Scheduler scheduler;
+        std::vector<Task<std::optional<int>>> batch;
+        batch.reserve(depth);
+        for (size_t i = 0; i < lookups.size(); i += depth) {
+          batch.clear();
+          for (size_t j = i; j < std::min(i + depth, lookups.size()); ++j) {
+            batch.emplace_back(bigAvl.asyncFind(lookups[j]));
+            scheduler.schedule(batch.back().coroutine());
+          }
+          scheduler.run();
+          for (size_t j = 0; j < batch.size(); ++j) {
+            assert(batch[j].result() == lookups[i + j]);
+          }
+        }
+      });
+    }
+  }
+
   // predecessor tests
   for (auto s : svec) {
     auto res = avl->predecessor(s);
@@ -112,6 +311,461 @@ auto main() -> int {
     assert(isMonotonicallyIncreasing(splitOnSpaces(avlStr)) == 1);
   }
 
+  // random remove tests
+  {
+    AVL<int, int> avl3(compareInts);
+    std::vector<int> keys(2000);
+    for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+      keys[static_cast<size_t>(i)] = i;
+    }
+    std::mt19937 gen(7);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (auto key : keys) {
+      avl3.insert(key, key);
+    }
+    assert(avl3.isValid());
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      avl3.remove(keys[i]);
+      assert(avl3.isValid());
+      assert(avl3.findKey(keys[i]).has_value() == false);
+      if (i % 100 == 0) {
+        for (size_t j = i + 1; j < keys.size(); ++j) {
+          assert(avl3.findKey(keys[j]).has_value());
+        }
+      }
+    }
+    assert(avl3.getRoot().has_value() == false);
+
+    // inserts y removes mezclados
+    std::uniform_int_distribution<int> dist(0, 499);
+    for (int i = 0; i < 20000; ++i) {
+      int key = dist(gen);
+      if (avl3.findKey(key).has_value()) {
+        avl3.remove(key);
+      } else {
+        avl3.iterativeInsert(key, key);
+      }
+      assert(avl3.isValid());
+    }
+  }
+
+  // AVLAlgorithms tests: inserts y removes por puntero mezclados
+  {
+    using Algorithms =
+        AVLAlgorithms<Connection, MemberHook<Connection, &Connection::byFd>>;
+    auto compare = [](const Connection* a, const Connection* b) {
+      return compareInts(a->fd, b->fd);
+    };
+    std::vector<Connection> connections(500);
+    std::vector<bool> linked(connections.size(), false);
+    Connection* root = nullptr;
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<size_t> dist(0, connections.size() - 1);
+    for (int i = 0; i < 20000; ++i) {
+      size_t index = dist(gen);
+      if (linked[index]) {
+        Algorithms::remove(root, &connections[index]);
+      } else {
+        connections[index].fd = static_cast<int>(index);
+        Algorithms::insert(root, &connections[index], compare);
+      }
+      linked[index] = !linked[index];
+      assert(Algorithms::isValid(root));
+    }
+  }
+
+  // intrusive avl tests
+  {
+    std::vector<Connection> connections(NODE_COUNT / 2);
+    for (size_t i = 0; i < connections.size(); ++i) {
+      connections[i].fd = static_cast<int>(i) * 2;
+      connections[i].peer = "bruh " + std::to_string(i * 2);
+    }
+    IntrusiveAVL<Connection, &Connection::byFd, ConnectionFd> table(
+        compareInts);
+    measureTime("intrusive avl insert", [&table, &connections]() {
+      for (auto& connection : connections) {
+        table.insert(&connection);
+      }
+    });
+    log("intrusive avl height with %zu nodes: %d\n", table.size(),
+        table.getHeight());
+    assert(table.getHeight() == avl2->getHeight());
+    for (auto s : svec) {
+      Connection* found = table.find(s);
+      assert(found != nullptr && found->peer == "bruh " + std::to_string(s));
+    }
+    assert(table.find(1) == nullptr);
+    assert(table.minimum()->fd == 0);
+    assert(table.maximum()->fd == NODE_COUNT - 2);
+    assert(table.successor(table.find(510))->fd == 512);
+
+    // unlink por puntero, sin buscar por llave
+    std::mt19937 gen(11);
+    std::vector<Connection*> order;
+    for (auto& connection : connections) {
+      order.push_back(&connection);
+    }
+    std::shuffle(order.begin(), order.end(), gen);
+    for (size_t i = 0; i < order.size() / 2; ++i) {
+      table.remove(order[i]);
+      assert(table.find(order[i]->fd) == nullptr);
+    }
+    assert(table.isValid());
+    assert(table.size() == order.size() - order.size() / 2);
+
+    // un objeto desenlazado no se puede volver a remover, ni uno enlazado
+    // volver a insertar
+    assert(table.isLinked(order[0]) == false);
+    assert(table.isLinked(order.back()));
+    bool threw = false;
+    try {
+      table.remove(order[0]);
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+      table.insert(order.back());
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+    assert(table.size() == order.size() - order.size() / 2);
+    assert(table.find(order.back()->fd) == order.back());
+    int previous = -1;
+    size_t visited = 0;
+    table.inorder([&previous, &visited](Connection& connection) {
+      assert(connection.fd > previous);
+      previous = connection.fd;
+      ++visited;
+    });
+    assert(visited == table.size());
+    table.clear();
+    assert(table.size() == 0 && table.minimum() == nullptr);
+
+    // dos árboles con el mismo hook: un objeto de `a` no está enlazado en `b`
+    IntrusiveAVL<Connection, &Connection::byFd, ConnectionFd> a(compareInts);
+    IntrusiveAVL<Connection, &Connection::byFd, ConnectionFd> b(compareInts);
+    for (size_t i = 0; i < 3; ++i) {
+      a.insert(&connections[i]);
+    }
+    b.insert(&connections[3]);
+    Connection* inA = a.minimum();
+    assert(a.isLinked(inA) && !b.isLinked(inA));
+    assert(!a.isLinked(&connections[3]) && b.isLinked(&connections[3]));
+    threw = false;
+    try {
+      b.remove(inA);
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+      b.insert(inA);
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+    assert(a.size() == 3 && b.size() == 1);
+    assert(a.isValid() && b.isValid());
+    assert(a.find(inA->fd) == inA && b.find(inA->fd) == nullptr);
+    a.clear();
+    b.clear();
+  }
+
+  // parallel build, forEach and reduce tests
+  {
+    std::vector<std::tuple<int, std::string>> items;
+    for (int i = 0; i <= NODE_COUNT; i += 2) {
+      items.emplace_back(i, "bruh " + std::to_string(i));
+    }
+    std::mt19937 gen(3);
+    std::shuffle(items.begin(), items.end(), gen);
+    ThreadPool pool(4);
+    AVL<int, std::string> avl4(compareInts);
+    avl4.buildParallel(items, pool);
+    assert(avl4.inorderString() == avl2->inorderString());
+    assert(avl4.getHeight() <= avl2->getHeight());
+    for (auto s : svec) {
+      assert(avl4.find(s).value() == "bruh " + std::to_string(s));
+    }
+    // el árbol armado en paralelo sigue siendo un AVL válido
+    avl4.insert(1, "bruh 1");
+    avl4.remove(510);
+    assert(isMonotonicallyIncreasing(splitOnSpaces(avl4.inorderString())));
+
+    std::atomic<long long> sum = 0;
+    avl4.parallelForEach(
+        [&sum](const int& key, const std::string& /*value*/) { sum += key; },
+        pool);
+    long long expected = 0;
+    avl4.inorder([&expected](const int& key, const std::string& /*value*/) {
+      expected += key;
+    });
+    assert(sum == expected);
+
+    // concatenar no es conmutativo: el resultado prueba que respeta el orden
+    std::string keys = avl4.parallelReduce<std::string>(
+        "",
+        [](const int& key, const std::string& /*value*/) {
+          return std::to_string(key) + " ";
+        },
+        [](const std::string& a, const std::string& b) { return a + b; },
+        pool);
+    assert(keys == avl4.inorderString());
+    auto allEven = [&avl4, &pool](int except) {
+      return avl4.parallelReduce<bool>(
+          true,
+          [except](const int& key, const std::string& /*value*/) {
+            return key % 2 == 0 || key == except;
+          },
+          [](const bool& a, const bool& b) { return a && b; }, pool);
+    };
+    assert(!allEven(-1));
+    assert(allEven(1));
+
+    // si `process` o `map` lanzan en este hilo, se esperan las tareas antes de
+    // propagar y el pool queda limpio para el siguiente uso
+    bool processThrew = false;
+    try {
+      avl4.parallelForEach(
+          [](const int& /*key*/, const std::string& /*value*/) {
+            throw "process failed";
+          },
+          pool);
+    } catch (const char* /*error*/) {
+      processThrew = true;
+    }
+    assert(processThrew);
+    bool mapThrew = false;
+    try {
+      avl4.parallelReduce<std::string>(
+          "",
+          [](const int& /*key*/, const std::string& /*value*/) -> std::string {
+            throw "map failed";
+          },
+          [](const std::string& a, const std::string& b) { return a + b; },
+          pool);
+    } catch (const char* /*error*/) {
+      mapThrew = true;
+    }
+    assert(mapThrew);
+    sum = 0;
+    avl4.parallelForEach(
+        [&sum](const int& key, const std::string& /*value*/) { sum += key; },
+        pool);
+    assert(sum == expected);
+
+    AVL<int, std::string> avl5(compareInts);
+    items.emplace_back(2, "bruh 2");
+    bool threw = false;
+    try {
+      avl5.buildParallel(items, pool);
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+  }
+
+  // parallel build and reduce benchmark, de 1 a `MAX_THREADS` hilos
+  {
+    std::vector<std::tuple<int, int>> items;
+    for (int i = 0; i < NODE_COUNT; ++i) {
+      items.emplace_back(i, i);
+    }
+    std::mt19937 gen(5);
+    std::shuffle(items.begin(), items.end(), gen);
+    for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+      ThreadPool pool(threads);
+      AVL<int, int> avl6(compareInts);
+      std::string name =
+          "avl parallel build (" + std::to_string(threads) + " threads)";
+      measureTime(name.c_str(),
+                  [&avl6, &items, &pool]() { avl6.buildParallel(items, pool); });
+      name = "avl parallel reduce (" + std::to_string(threads) + " threads)";
+      measureTime(name.c_str(), [&avl6, &pool]() {
+        long long total = avl6.parallelReduce<long long>(
+            0, [](const int& key, const int& /*value*/) { return key; },
+            [](const long long& a, const long long& b) { return a + b; },
+            pool);
+        assert(total ==
+               static_cast<long long>(NODE_COUNT) * (NODE_COUNT - 1) / 2);
+      });
+    }
+  }
+
+  // trace tests
+  {
+    const char* tracePath = "avltest.trace";
+    {
+      TraceRecorder recorder(tracePath);
+      AVL<int, int> avl7(compareInts);
+      avl7.setTraceRecorder(&recorder);
+      for (int i = 0; i < 10000; ++i) {
+        avl7.iterativeInsert(i, i);
+      }
+      for (int i = 0; i < 10000; i += 3) {
+        assert(avl7.find(i).has_value());
+      }
+      avl7.remove(42);
+      avl7.setTraceRecorder(nullptr);
+      avl7.remove(43);
+    }
+    {
+      TraceReader trace(tracePath);
+      assert(trace.size() == 10000 + 3334 + 1);
+      uint64_t previous = 0;
+      size_t i = 0;
+      for (const TraceRecord& record : trace) {
+        assert(record.timestamp() >= previous);
+        previous = record.timestamp();
+        if (i < 10000) {
+          assert(record.op() == TraceOp::Insert);
+          assert(record.key == static_cast<int64_t>(i));
+        } else if (i < 10000 + 3334) {
+          assert(record.op() == TraceOp::Find);
+          assert(record.key == static_cast<int64_t>(i - 10000) * 3);
+        } else {
+          assert(record.op() == TraceOp::Remove && record.key == 42);
+        }
+        ++i;
+      }
+    }
+    std::remove(tracePath);
+
+    // búsquedas concurrentes sobre un AVL que se está grabando
+    {
+      TraceRecorder recorder(tracePath);
+      AVL<int, int> avl8(compareInts);
+      for (int i = 0; i < 10000; ++i) {
+        avl8.insert(i, i);
+      }
+      avl8.setTraceRecorder(&recorder);
+      ThreadPool pool(4);
+      avl8.parallelForEach(
+          [&avl8](const int& key, const int& /*value*/) {
+            assert(avl8.find(key).has_value());
+          },
+          pool);
+    }
+    {
+      TraceReader trace(tracePath);
+      assert(trace.size() == 10000);
+      uint64_t previous = 0;
+      for (const TraceRecord& record : trace) {
+        assert(record.op() == TraceOp::Find);
+        assert(record.timestamp() >= previous);
+        previous = record.timestamp();
+      }
+    }
+    std::FILE* truncated = std::fopen(tracePath, "ab");
+    std::fputc(0, truncated);
+    std::fclose(truncated);
+    bool rejected = false;
+    try {
+      TraceReader trace(tracePath);
+    } catch (const char* /*error*/) {
+      rejected = true;
+    }
+    assert(rejected);
+    std::remove(tracePath);
+
+    // un disco lleno no deja un trace truncado en silencio
+    bool threw = false;
+    try {
+      TraceRecorder recorder("/dev/full");
+    } catch (const char* /*error*/) {
+      threw = true;
+    }
+    assert(threw);
+  }
+
+  // cache tests
+  {
+    using namespace std::chrono_literals;
+    AVLCache<int, std::string> cache(3, compareInts);
+    auto now = std::chrono::steady_clock::now();
+    cache.put(1, "one", {}, now);
+    cache.put(2, "two", 10s, now);
+    cache.put(3, "three", 5s, now);
+    assert(cache.get(1, now).value() == "one");
+    // 2 es el menos usado, sale por capacidad
+    cache.put(4, "four", {}, now);
+    assert(cache.get(2, now).has_value() == false);
+    assert(cache.size() == 3);
+    // 3 expira antes que cualquier otro
+    assert(cache.expire(now + 5s) == 1);
+    assert(cache.get(3, now + 5s).has_value() == false);
+    cache.put(1, "uno", 1s, now + 5s);
+    assert(cache.get(1, now + 5s).value() == "uno");
+    assert(cache.get(1, now + 6s).has_value() == false);
+    // con el cache lleno, una entrada expirada se libera antes que la LRU
+    cache.put(5, "five", 1s, now);
+    cache.put(6, "six", {}, now);
+    cache.put(7, "seven", {}, now + 2s);
+    assert(cache.get(4, now + 2s).value() == "four");
+    assert(cache.get(6, now + 2s).value() == "six");
+    cache.remove(6);
+    assert(cache.get(6, now + 2s).has_value() == false);
+    CacheStats stats = cache.getStats();
+    assert(stats.hits == 4);
+    assert(stats.misses == 4);
+    assert(stats.evictions == 1);
+    assert(stats.expirations == 3);
+  }
+
+  // cache benchmark: accesos con distribución Zipf, un `put` por cada miss
+  {
+    std::vector<double> weights(CACHE_KEYS);
+    for (size_t i = 0; i < weights.size(); ++i) {
+      weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), 0.99);
+    }
+    std::discrete_distribution<int> zipf(weights.begin(), weights.end());
+    std::mt19937 gen(42);
+    std::vector<int> accesses(CACHE_OPS);
+    for (auto& key : accesses) {
+      key = zipf(gen);
+    }
+    auto ttl = std::chrono::seconds(60);
+
+    AVLCache<int, std::string> cache(CACHE_CAPACITY, compareInts);
+    measureTime("avl cache zipf", [&cache, &accesses, ttl]() {
+      auto now = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < accesses.size(); ++i) {
+        if (i % 1000 == 0) {
+          now = std::chrono::steady_clock::now();
+          cache.expire(now);
+        }
+        if (!cache.get(accesses[i], now).has_value()) {
+          cache.put(accesses[i], "bruh " + std::to_string(accesses[i]), ttl,
+                    now);
+        }
+      }
+    });
+    CacheStats stats = cache.getStats();
+    log("avl cache zipf hits: %zu, misses: %zu, evictions: %zu\n", stats.hits,
+        stats.misses, stats.evictions);
+
+    ThreeStructureCache baseline(CACHE_CAPACITY);
+    measureTime("avl + list + heap cache zipf", [&baseline, &accesses, ttl]() {
+      auto now = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < accesses.size(); ++i) {
+        if (i % 1000 == 0) {
+          now = std::chrono::steady_clock::now();
+          baseline.expire(now);
+        }
+        if (!baseline.get(accesses[i], now).has_value()) {
+          baseline.put(accesses[i], "bruh " + std::to_string(accesses[i]),
+                       ttl, now);
+        }
+      }
+    });
+  }
+
   delete avl;
   delete avl2;
 